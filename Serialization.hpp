@@ -99,4 +99,1962 @@ namespace Serialization
     template <std::size_t _extent, typename... Args>
     constexpr auto deserialize(std::span<const std::byte, _extent> buffer, std::endian sourceEndian, Args &&...args);
 
+    //*****************************************************************************
+    // Строки и проверка UTF-8 при десериализации.
+    //*****************************************************************************
+
+    // Формат строки: длина строки в байтах (std::uint32_t в порядке байтов
+    // targetEndian/sourceEndian), затем байты строки в UTF-8 без завершающего нуля.
+
+    /// Сериализует строку inValue во входной буфер.
+    /// Если буфер недостаточен или длина строки больше std::numeric_limits<std::uint32_t>::max(),
+    /// буфер возвращается без смещения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Строка для сериализации.
+    /// @param  targetEndian  Порядок байтов префикса длины в результате.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, std::string_view inValue, std::endian targetEndian) noexcept;
+
+    /// Сериализует строку inValue во входной буфер.
+    /// Формат и поведение совпадают с перегрузкой для std::string_view.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Строка для сериализации.
+    /// @param  targetEndian  Порядок байтов префикса длины в результате.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::string &inValue, std::endian targetEndian) noexcept;
+
+    /// Режим проверки содержимого строки при десериализации.
+    enum class Utf8Validation
+    {
+        none,     ///< Байты строки копируются без проверки.
+        validate  ///< Байты строки проверяются на корректность UTF-8.
+    };
+
+    /// Проверяет, что входной буфер содержит корректную последовательность UTF-8
+    /// (без overlong-кодировок, суррогатов и кодовых точек больше U+10FFFF).
+    /// Проверка выполняется векторным алгоритмом по блокам (SSE4.2/AVX2/NEON при наличии,
+    /// иначе скалярный путь) с досрочным пропуском ASCII-блоков.
+    /// @param  buffer  Входной буфер.
+    /// @return         true, если буфер содержит корректный UTF-8.
+    bool isValidUtf8(std::span<const std::byte> buffer) noexcept;
+
+    /// Десериализует строку из входного буфера в resultValue, проверяя UTF-8
+    /// за тот же проход, в котором выполняется копирование.
+    /// При обнаружении некорректной последовательности или если длина строки больше
+    /// остатка буфера, resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованная строка.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  validation    Режим проверки UTF-8.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::string &resultValue, std::endian sourceEndian, Utf8Validation validation = Utf8Validation::none);
+
+    /// Десериализует строку из входного буфера в представление resultValue,
+    /// указывающее на данные внутри buffer, проверяя UTF-8 без копирования.
+    /// При обнаружении некорректной последовательности или если длина строки больше
+    /// остатка буфера, resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен существовать, пока используется resultValue.
+    /// @param  resultValue   Представление десериализованной строки.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  validation    Режим проверки UTF-8.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::string_view &resultValue, std::endian sourceEndian, Utf8Validation validation = Utf8Validation::none) noexcept;
+
+    //*****************************************************************************
+    // Перекодирование UTF-16/UTF-32 при сериализации строк.
+    //*****************************************************************************
+
+    // Формат строки в кодировке StringEncoding: длина закодированных данных в байтах
+    // (std::uint32_t в порядке байтов targetEndian/sourceEndian, а не количество кодовых единиц),
+    // затем закодированные данные без завершающего нуля. Для StringEncoding::utf8 формат
+    // совпадает с форматом std::string, поэтому такие данные можно десериализовать и в std::string.
+    // Так как длина результата перекодирования заранее неизвестна, префикс длины
+    // записывается после перекодирования данных.
+
+    /// Кодировка строки в бинарном представлении.
+    enum class StringEncoding
+    {
+        utf8,   ///< UTF-8.
+        utf16,  ///< UTF-16 с порядком байтов targetEndian/sourceEndian.
+        utf32   ///< UTF-32 с порядком байтов targetEndian/sourceEndian.
+    };
+
+    /// Сериализует строку UTF-16 inValue во входной буфер в кодировке targetEncoding.
+    /// Перекодирование выполняется векторно непосредственно в buffer, без временной строки.
+    /// Если буфер недостаточен, inValue содержит непарный суррогат или длина закодированных
+    /// данных больше std::numeric_limits<std::uint32_t>::max(), буфер возвращается без смещения.
+    /// @tparam _extent         Extent входного буфера.
+    /// @param  buffer          Входной буфер.
+    /// @param  inValue         Строка для сериализации.
+    /// @param  targetEndian    Порядок байтов в результате.
+    /// @param  targetEncoding  Кодировка строки в результате.
+    /// @return                 buffer со смещением.
+    template <size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::u16string &inValue, std::endian targetEndian, StringEncoding targetEncoding) noexcept;
+
+    /// Сериализует строку UTF-32 inValue во входной буфер в кодировке targetEncoding.
+    /// Перекодирование выполняется векторно непосредственно в buffer, без временной строки.
+    /// Если буфер недостаточен, inValue содержит недопустимую кодовую точку или длина закодированных
+    /// данных больше std::numeric_limits<std::uint32_t>::max(), буфер возвращается без смещения.
+    /// @tparam _extent         Extent входного буфера.
+    /// @param  buffer          Входной буфер.
+    /// @param  inValue         Строка для сериализации.
+    /// @param  targetEndian    Порядок байтов в результате.
+    /// @param  targetEncoding  Кодировка строки в результате.
+    /// @return                 buffer со смещением.
+    template <size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::u32string &inValue, std::endian targetEndian, StringEncoding targetEncoding) noexcept;
+
+    /// Десериализует строку в кодировке sourceEncoding из входного буфера в строку UTF-16 resultValue.
+    /// Перекодирование выполняется векторно непосредственно в resultValue.
+    /// При некорректных входных данных resultValue не изменяется,
+    /// а буфер возвращается без смещения.
+    /// @tparam _extent         Extent входного буфера.
+    /// @param  buffer          Входной буфер.
+    /// @param  resultValue     Десериализованная строка.
+    /// @param  sourceEndian    Порядок байтов во входном буфере.
+    /// @param  sourceEncoding  Кодировка строки во входном буфере.
+    /// @return                 buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::u16string &resultValue, std::endian sourceEndian, StringEncoding sourceEncoding);
+
+    /// Десериализует строку в кодировке sourceEncoding из входного буфера в строку UTF-32 resultValue.
+    /// Перекодирование выполняется векторно непосредственно в resultValue.
+    /// При некорректных входных данных resultValue не изменяется,
+    /// а буфер возвращается без смещения.
+    /// @tparam _extent         Extent входного буфера.
+    /// @param  buffer          Входной буфер.
+    /// @param  resultValue     Десериализованная строка.
+    /// @param  sourceEndian    Порядок байтов во входном буфере.
+    /// @param  sourceEncoding  Кодировка строки во входном буфере.
+    /// @return                 buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::u32string &resultValue, std::endian sourceEndian, StringEncoding sourceEncoding);
+
+    //*****************************************************************************
+    // Интернирование строк при десериализации.
+    //*****************************************************************************
+
+    /// Таблица интернирования строк.
+    /// Хранит по одному экземпляру каждой встреченной строки в собственном пуле памяти.
+    /// Поиск выполняется по хешу в таблице с открытой адресацией; кандидаты
+    /// сравниваются векторно. Представления, выданные таблицей, действительны
+    /// до вызова clear() или уничтожения таблицы.
+    class StringInternPool
+    {
+    public:
+        /// Создаёт таблицу интернирования.
+        /// @param  expectedCount  Ожидаемое количество уникальных строк (для предварительного резервирования).
+        explicit StringInternPool(std::size_t expectedCount = 0);
+
+        StringInternPool(const StringInternPool &) = delete;
+        StringInternPool &operator=(const StringInternPool &) = delete;
+
+        /// Возвращает представление интернированной копии строки value,
+        /// добавляя её в таблицу, если она отсутствует.
+        /// @param  value  Строка для интернирования.
+        /// @return        Представление строки в пуле.
+        std::string_view intern(std::string_view value);
+
+        /// @return  Количество уникальных строк в таблице.
+        std::size_t size() const noexcept;
+
+        /// @return  Объём памяти, занятый строками в пуле, в байтах.
+        std::size_t memoryUsage() const noexcept;
+
+        /// Удаляет все строки из таблицы. Ранее выданные представления становятся недействительными.
+        void clear() noexcept;
+    };
+
+    /// Десериализует строку из входного буфера, интернируя её в pool.
+    /// resultValue указывает на экземпляр строки в pool, поэтому повторяющиеся строки
+    /// не требуют выделения памяти и хранятся в одном экземпляре.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Представление десериализованной строки в pool.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  pool          Таблица интернирования.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::string_view &resultValue, std::endian sourceEndian, StringInternPool &pool);
+
+    /// Десериализует строку из входного буфера, интернируя её в pool, с проверкой UTF-8.
+    /// Строка проверяется до поиска в таблице; некорректная строка в pool не добавляется,
+    /// resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Представление десериализованной строки в pool.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  pool          Таблица интернирования.
+    /// @param  validation    Режим проверки UTF-8.
+    /// @return               buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::string_view &resultValue, std::endian sourceEndian, StringInternPool &pool, Utf8Validation validation);
+
+    //*****************************************************************************
+    // Сериализация графов объектов.
+    //*****************************************************************************
+
+    /// Контекст сериализации графа объектов.
+    /// Сопоставляет адресам уже записанных объектов их идентификаторы
+    /// (плоская хеш-таблица с открытой адресацией), благодаря чему каждый
+    /// разделяемый объект записывается один раз, а последующие ссылки на него
+    /// записываются как обратные ссылки.
+    /// Ссылка на объект записывается как идентификатор переменной длины:
+    /// 0 - нулевой указатель, 1 - новый объект (за ним следует сам объект),
+    /// n > 1 - обратная ссылка на объект с идентификатором n - 2.
+    /// Идентификатор кодируется как беззнаковый LEB128 (не зависит от порядка байтов):
+    /// по 7 бит значения на байт начиная с младших, старший бит байта равен 1, если за ним
+    /// следует ещё один байт; значение занимает не более 10 байт и не превышает 2^64 - 1.
+    /// Объектам присваиваются идентификаторы 0, 1, 2, ... в порядке их первой записи.
+    class GraphWriteContext
+    {
+    public:
+        /// Создаёт контекст сериализации графа.
+        /// @param  expectedCount  Ожидаемое количество разделяемых объектов.
+        explicit GraphWriteContext(std::size_t expectedCount = 0);
+
+        /// @return  Количество уже записанных объектов.
+        std::size_t size() const noexcept;
+
+        /// Сбрасывает контекст для сериализации нового графа.
+        void clear() noexcept;
+    };
+
+    /// Контекст десериализации графа объектов.
+    /// Хранит восстановленные объекты в порядке их идентификаторов, что позволяет
+    /// разрешать обратные ссылки обращением по индексу.
+    class GraphReadContext
+    {
+    public:
+        /// Создаёт контекст десериализации графа.
+        /// @param  expectedCount  Ожидаемое количество разделяемых объектов.
+        explicit GraphReadContext(std::size_t expectedCount = 0);
+
+        /// @return  Количество уже восстановленных объектов.
+        std::size_t size() const noexcept;
+
+        /// Сбрасывает контекст для десериализации нового графа.
+        void clear() noexcept;
+    };
+
+    /// Сериализует объект, на который указывает inValue, во входной буфер.
+    /// Объект записывается только при первой встрече в context; при повторных
+    /// встречах записывается обратная ссылка. Сам объект сериализуется найденной по ADL
+    /// функцией serialize(buffer, object, targetEndian, context), а при её отсутствии -
+    /// функцией serialize(buffer, object, targetEndian).
+    /// @tparam T             Тип объекта.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Указатель на объект для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  context       Контекст сериализации графа.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::shared_ptr<T> &inValue, std::endian targetEndian, GraphWriteContext &context);
+
+    /// Сериализует объект, на который указывает inValue, во входной буфер.
+    /// Поведение аналогично перегрузке для std::shared_ptr.
+    /// @tparam T             Тип объекта.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Указатель на объект для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  context       Контекст сериализации графа.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const T *inValue, std::endian targetEndian, GraphWriteContext &context);
+
+    /// Десериализует ссылку на объект из входного буфера в resultValue.
+    /// Новый объект создаётся, регистрируется в context и десериализуется найденной по ADL
+    /// функцией deserialize(buffer, object, sourceEndian, context), а при её отсутствии -
+    /// функцией deserialize(buffer, object, sourceEndian). Обратная ссылка разрешается
+    /// в уже созданный объект, так что разделение объектов восстанавливается.
+    /// context хранит вместе с каждым объектом его тип. Если идентификатор закодирован
+    /// некорректно (больше 10 байт или больше 2^64 - 1), обратная ссылка n указывает
+    /// на несуществующий объект (n - 2 >= context.size()) или на объект, созданный
+    /// с типом, отличным от T, resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam T             Тип объекта. Должен быть конструируемым по умолчанию.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Указатель на десериализованный объект.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  context       Контекст десериализации графа.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::shared_ptr<T> &resultValue, std::endian sourceEndian, GraphReadContext &context);
+
+    /// Десериализует ссылку на объект из входного буфера в невладеющий указатель resultValue.
+    /// Объект принадлежит context и существует до его очистки или уничтожения.
+    /// Проверки идентификатора и типа обратной ссылки - как в перегрузке для std::shared_ptr.
+    /// @tparam T             Тип объекта. Должен быть конструируемым по умолчанию.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Указатель на десериализованный объект.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  context       Контекст десериализации графа.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T *&resultValue, std::endian sourceEndian, GraphReadContext &context);
+
+    //*****************************************************************************
+    // Позиционно-независимое размещение объектов (in-place layout).
+    //*****************************************************************************
+
+    /// Самоотносительный указатель для позиционно-независимого размещения.
+    /// Хранит смещение в байтах от собственного адреса до целевого объекта
+    /// (0 - нулевой указатель), поэтому остаётся действительным при отображении
+    /// буфера в память по любому адресу.
+    /// Смещение имеет смысл только по месту в буфере, поэтому копирование запрещено
+    /// (как и копирование типов, содержащих RelativePtr); значение задаётся
+    /// функцией InPlaceBuilder::link.
+    /// @tparam T  Тип целевого объекта.
+    template <typename T>
+    class RelativePtr
+    {
+    public:
+        RelativePtr() noexcept = default;
+        RelativePtr(const RelativePtr &) = delete;
+        RelativePtr &operator=(const RelativePtr &) = delete;
+
+        /// @return  Указатель на целевой объект или nullptr.
+        const T *get() const noexcept;
+
+        const T &operator*() const noexcept;
+        const T *operator->() const noexcept;
+        explicit operator bool() const noexcept;
+
+    private:
+        friend class InPlaceBuilder;
+
+        std::int64_t _offset = 0;
+    };
+
+    /// Самоотносительный массив для позиционно-независимого размещения.
+    /// Хранит смещение до первого элемента и количество элементов.
+    /// Как и RelativePtr, используется только по месту в буфере: копирование запрещено,
+    /// значение задаётся функцией InPlaceBuilder::link.
+    /// @tparam T  Тип элементов массива.
+    template <typename T>
+    class RelativeArray
+    {
+    public:
+        RelativeArray() noexcept = default;
+        RelativeArray(const RelativeArray &) = delete;
+        RelativeArray &operator=(const RelativeArray &) = delete;
+
+        /// @return  Элементы массива.
+        std::span<const T> get() const noexcept;
+
+        std::size_t size() const noexcept;
+        const T &operator[](std::size_t index) const noexcept;
+        const T *begin() const noexcept;
+        const T *end() const noexcept;
+
+    private:
+        friend class InPlaceBuilder;
+
+        std::int64_t _offset = 0;
+        std::uint64_t _size = 0;
+    };
+
+    /// Построитель позиционно-независимого размещения в буфере.
+    /// Размещает объекты в buffer с выравниванием alignof(T) относительно начала буфера
+    /// и записывает в начало буфера заголовок с порядком байтов (std::endian::native),
+    /// размером данных и смещением корневого объекта.
+    /// Типы размещаемых объектов должны быть агрегатами со стандартным размещением
+    /// и тривиальным деструктором и содержать только арифметические типы, перечисления,
+    /// RelativePtr, RelativeArray и такие же типы. Такие объекты используются только
+    /// по месту в буфере: копирование их за пределы буфера запрещено.
+    /// Начало buffer должно быть выровнено не менее чем по alignof(std::max_align_t).
+    class InPlaceBuilder
+    {
+    public:
+        /// Создаёт построитель в buffer.
+        /// @param  buffer  Выходной буфер.
+        explicit InPlaceBuilder(std::span<std::byte> buffer) noexcept;
+
+        /// Размещает в буфере объект типа T, инициализированный значением по умолчанию.
+        /// @tparam T  Тип объекта.
+        /// @return    Указатель на объект или nullptr, если буфер недостаточен.
+        template <typename T>
+        T *create() noexcept;
+
+        /// Размещает в буфере массив из count объектов типа T, инициализированных значением по умолчанию.
+        /// @tparam T      Тип элементов.
+        /// @param  count  Количество элементов.
+        /// @return        Элементы массива или пустой span, если буфер недостаточен.
+        template <typename T>
+        std::span<T> createArray(std::size_t count) noexcept;
+
+        /// Записывает в pointer смещение до target.
+        /// pointer и target должны быть размещены этим построителем.
+        /// @tparam T        Тип целевого объекта.
+        /// @param  pointer  Самоотносительный указатель.
+        /// @param  target   Целевой объект или nullptr.
+        template <typename T>
+        void link(RelativePtr<T> &pointer, const T *target) noexcept;
+
+        /// Записывает в array смещение до первого из elements и их количество.
+        /// array и elements должны быть размещены этим построителем.
+        /// @tparam T         Тип элементов массива.
+        /// @param  array     Самоотносительный массив.
+        /// @param  elements  Элементы массива. Тип T выводится только из array, поэтому
+        ///                   передаётся и результат createArray<T> (std::span<T>).
+        template <typename T>
+        void link(RelativeArray<T> &array, std::type_identity_t<std::span<const T>> elements) noexcept;
+
+        /// Задаёт корневой объект размещения.
+        /// @tparam T     Тип корневого объекта.
+        /// @param  root  Корневой объект, размещённый этим построителем.
+        template <typename T>
+        void setRoot(const T *root) noexcept;
+
+        /// Завершает размещение, записывая заголовок.
+        /// @return  Использованная часть буфера.
+        std::span<std::byte> finish() noexcept;
+    };
+
+    /// Возвращает корневой объект позиционно-независимого размещения в buffer
+    /// (например, в отображённом в память файле) без разбора данных: проверяются
+    /// только заголовок, выравнивание и размер, поэтому время загрузки - O(1).
+    /// @tparam T       Тип корневого объекта.
+    /// @param  buffer  Входной буфер, созданный InPlaceBuilder.
+    /// @return         Указатель на корневой объект или nullptr, если заголовок некорректен,
+    ///                 порядок байтов отличается от std::endian::native или буфер неверно выровнен.
+    template <typename T>
+    const T *inPlaceRoot(std::span<const std::byte> buffer) noexcept;
+
+    //*****************************************************************************
+    // Плоские отсортированные отображения.
+    //*****************************************************************************
+
+    /// Размещение ключей в плоском отображении.
+    enum class MapLayout
+    {
+        sorted,    ///< Ключи по возрастанию, поиск двоичный.
+        eytzinger  ///< Ключи в порядке Эйтцингера (обход дерева в ширину), поиск без ветвлений.
+    };
+
+    /// Сериализует отображение inValue во входной буфер в плоском виде:
+    /// количество элементов (std::uint64_t), размещение (std::uint8_t), размеры заполнителей
+    /// перед массивом ключей и перед массивом значений (по std::uint8_t), затем заполнитель
+    /// из нулевых байтов, массив ключей, заполнитель и массив значений в том же порядке.
+    /// Заполнители выравнивают массивы по alignof(Key) и alignof(Value) относительно origin;
+    /// так как их размеры записаны в буфер, читатель находит массивы при любом адресе буфера.
+    /// Для доступа без копирования буфер при чтении должен располагаться по адресу с тем же
+    /// выравниванием, что и origin (например, начало отображённого в память файла).
+    /// Значение-структура записывается побайтно и не может быть переставлено по байтам,
+    /// поэтому для него targetEndian должен совпадать с std::endian::native; в противном
+    /// случае буфер возвращается без смещения. Если буфер недостаточен, буфер также
+    /// возвращается без смещения.
+    /// @tparam Key           Тип ключа. Арифметический тип или перечисление.
+    /// @tparam Value         Тип значения. Арифметический тип, перечисление или тривиально
+    ///                       копируемая структура (только для std::endian::native).
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен находиться внутри буфера, начинающегося с origin.
+    /// @param  inValue       Отображение для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  layout        Размещение ключей.
+    /// @param  origin        Начало буфера, относительно которого выравниваются массивы.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::map<Key, Value> &inValue, std::endian targetEndian, MapLayout layout, const std::byte *origin) noexcept;
+
+    /// Сериализует неупорядоченное отображение inValue во входной буфер в плоском виде.
+    /// Элементы сортируются непосредственно в buffer, без дополнительного выделения памяти.
+    /// Формат и ограничения совпадают с перегрузкой для std::map.
+    /// @tparam Key           Тип ключа. Арифметический тип или перечисление.
+    /// @tparam Value         Тип значения. Арифметический тип, перечисление или тривиально
+    ///                       копируемая структура (только для std::endian::native).
+    /// @tparam Hash          Хеш-функция отображения.
+    /// @tparam KeyEqual      Функция сравнения ключей отображения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен находиться внутри буфера, начинающегося с origin.
+    /// @param  inValue       Отображение для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  layout        Размещение ключей.
+    /// @param  origin        Начало буфера, относительно которого выравниваются массивы.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, typename Hash, typename KeyEqual, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::unordered_map<Key, Value, Hash, KeyEqual> &inValue, std::endian targetEndian, MapLayout layout, const std::byte *origin) noexcept;
+
+    /// Представление плоского отображения, указывающее на данные в буфере.
+    /// Поиск выполняется непосредственно по массиву ключей, без построения отображения.
+    /// @tparam Key    Тип ключа.
+    /// @tparam Value  Тип значения.
+    template <typename Key, typename Value>
+    class FlatMapView
+    {
+    public:
+        /// Ищет значение по ключу.
+        /// @param  key  Ключ.
+        /// @return      Указатель на значение или nullptr, если ключ отсутствует.
+        const Value *find(const Key &key) const noexcept;
+
+        /// @return  Количество элементов.
+        std::size_t size() const noexcept;
+
+        /// @return  Массив ключей в порядке размещения.
+        std::span<const Key> keys() const noexcept;
+
+        /// @return  Массив значений в порядке размещения ключей.
+        std::span<const Value> values() const noexcept;
+
+        /// @return  Размещение ключей.
+        MapLayout layout() const noexcept;
+    };
+
+    /// Десериализует плоское отображение из входного буфера в представление resultValue без копирования.
+    /// Массивы находятся по записанным в буфере размерам заполнителей. Если sourceEndian
+    /// отличается от std::endian::native или найденные массивы не выровнены по alignof(Key)
+    /// и alignof(Value) (буфер расположен по адресу с другим выравниванием, чем при записи),
+    /// resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam Key           Тип ключа.
+    /// @tparam Value         Тип значения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен существовать, пока используется resultValue.
+    /// @param  resultValue   Представление десериализованного отображения.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, FlatMapView<Key, Value> &resultValue, std::endian sourceEndian) noexcept;
+
+    /// Десериализует плоское отображение из входного буфера в resultValue.
+    /// Элементы вставляются в порядке возрастания ключей с подсказкой позиции,
+    /// поэтому построение отображения выполняется за линейное время.
+    /// Выравнивание буфера не требуется. Если Value - структура, а sourceEndian отличается
+    /// от std::endian::native, resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam Key           Тип ключа.
+    /// @tparam Value         Тип значения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованное отображение.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::map<Key, Value> &resultValue, std::endian sourceEndian);
+
+    //*****************************************************************************
+    // Сохраняемые хеш-таблицы с открытой адресацией.
+    //*****************************************************************************
+
+    /// Параметры сохраняемой хеш-таблицы.
+    struct HashTableOptions
+    {
+        std::uint64_t seed = 0;        ///< Начальное значение хеш-функции. Сохраняется в буфере.
+        float maxLoadFactor = 0.875f;  ///< Максимальный коэффициент заполнения. Сохраняется в буфере.
+    };
+
+    /// Вычисляет хеш ключа, используемый сохраняемыми хеш-таблицами.
+    /// Алгоритм - XXH64 (64-битный xxHash) байтов key с начальным значением seed.
+    /// В отличие от std::hash, результат не зависит от платформы, стандартной библиотеки
+    /// и версии библиотеки (смена алгоритма требует новой версии формата таблицы),
+    /// поэтому таблица, записанная одним процессом, может быть прочитана другим.
+    /// @param  key   Байтовое представление ключа в порядке байтов таблицы.
+    /// @param  seed  Начальное значение хеш-функции.
+    /// @return       Хеш ключа.
+    std::uint64_t hashKey(std::span<const std::byte> key, std::uint64_t seed) noexcept;
+
+    /// Сериализует неупорядоченное отображение inValue во входной буфер в виде готовой
+    /// к поиску хеш-таблицы с открытой адресацией (в стиле Swiss table): заголовок
+    /// (количество элементов, ёмкость, seed, maxLoadFactor и размеры заполнителей перед
+    /// массивами ключей и значений), массив управляющих байтов, массив ключей и массив значений.
+    /// Ёмкость - наименьшая степень двойки не меньше 16 (размер группы), при которой
+    /// количество элементов не больше ёмкость * maxLoadFactor и меньше ёмкости, поэтому
+    /// в таблице всегда есть пустая ячейка. Ячейки разбиты на groupCount = ёмкость / 16 групп.
+    /// Для ключа с хешем h = hashKey(байты ключа, seed):
+    ///   управляющий байт занятой ячейки - h >> 57 (7 старших битов хеша, старший бит байта 0);
+    ///   управляющий байт пустой ячейки - 0x80;
+    ///   начальная группа - g0 = h & (groupCount - 1) (младшие биты хеша);
+    ///   последовательность проб - группы g_i = (g0 + i * (i + 1) / 2) & (groupCount - 1),
+    ///   i = 0, 1, 2, ... (треугольные числа обходят все группы при groupCount - степени двойки),
+    ///   внутри группы ячейки просматриваются по возрастанию индекса.
+    /// Элемент записывается в первую пустую ячейку последовательности проб; удалённых ячеек
+    /// нет, так как таблица записывается один раз. Поиск проверяет группы в том же порядке
+    /// и заканчивается на первой группе, содержащей пустую ячейку.
+    /// Расположение элементов может зависеть от порядка обхода inValue, но читатель любой
+    /// сборки находит элемент по той же последовательности проб.
+    /// Массивы выравниваются относительно origin так же, как в плоских отображениях.
+    /// Значение-структура записывается побайтно и не может быть переставлено по байтам,
+    /// поэтому для него targetEndian должен совпадать с std::endian::native; в противном
+    /// случае буфер возвращается без смещения.
+    /// @tparam Key           Тип ключа. Арифметический тип или перечисление.
+    /// @tparam Value         Тип значения. Арифметический тип, перечисление или тривиально
+    ///                       копируемая структура (только для std::endian::native).
+    /// @tparam Hash          Хеш-функция отображения (в формате не используется).
+    /// @tparam KeyEqual      Функция сравнения ключей отображения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен находиться внутри буфера, начинающегося с origin.
+    /// @param  inValue       Отображение для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  options       Параметры хеш-таблицы.
+    /// @param  origin        Начало буфера, относительно которого выравниваются массивы.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, typename Hash, typename KeyEqual, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::unordered_map<Key, Value, Hash, KeyEqual> &inValue, std::endian targetEndian, const HashTableOptions &options, const std::byte *origin) noexcept;
+
+    /// Представление сохранённой хеш-таблицы, указывающее на данные в буфере.
+    /// Поиск проверяет группу из 16 управляющих байтов одной векторной операцией
+    /// (SSE2/NEON, иначе скалярный путь) и сравнивает ключи только у совпавших ячеек.
+    /// @tparam Key    Тип ключа.
+    /// @tparam Value  Тип значения.
+    template <typename Key, typename Value>
+    class HashTableView
+    {
+    public:
+        /// Ищет значение по ключу.
+        /// @param  key  Ключ.
+        /// @return      Указатель на значение или nullptr, если ключ отсутствует.
+        const Value *find(const Key &key) const noexcept;
+
+        /// @return  Количество элементов.
+        std::size_t size() const noexcept;
+
+        /// @return  Количество ячеек таблицы.
+        std::size_t capacity() const noexcept;
+
+        /// @return  Параметры, с которыми была записана таблица.
+        HashTableOptions options() const noexcept;
+    };
+
+    /// Десериализует хеш-таблицу из входного буфера в представление resultValue без копирования;
+    /// время загрузки - O(1). Массивы находятся по записанным в буфере размерам заполнителей.
+    /// Если sourceEndian отличается от std::endian::native или найденные массивы не выровнены,
+    /// resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam Key           Тип ключа.
+    /// @tparam Value         Тип значения.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен существовать, пока используется resultValue.
+    /// @param  resultValue   Представление десериализованной хеш-таблицы.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename Key, typename Value, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, HashTableView<Key, Value> &resultValue, std::endian sourceEndian) noexcept;
+
+    //*****************************************************************************
+    // Полиморфные типы.
+    //*****************************************************************************
+
+    /// Компактный идентификатор типа в иерархии. Значение 0 зарезервировано для нулевого указателя.
+    using TypeId = std::uint16_t;
+
+    /// Функции сериализации, десериализации и создания для одного производного типа.
+    /// @tparam Base  Базовый тип иерархии.
+    template <typename Base>
+    struct PolymorphicEntry
+    {
+        std::span<std::byte> (*serialize)(std::span<std::byte> buffer, const Base &inValue, std::endian targetEndian) noexcept = nullptr;
+        /// Не noexcept: десериализация производного типа со строками или массивами выделяет память
+        /// и может выбросить std::bad_alloc.
+        std::span<const std::byte> (*deserialize)(std::span<const std::byte> buffer, Base &resultValue, std::endian sourceEndian) = nullptr;
+        std::unique_ptr<Base> (*construct)() = nullptr;
+    };
+
+    /// Реестр производных типов иерархии Base.
+    /// Записи хранятся в плотном массиве, индексируемом TypeId, поэтому выбор функции
+    /// по идентификатору - одно обращение по индексу и один косвенный вызов.
+    /// Регистрация выполняется при статической инициализации (см. polymorphicRegistration),
+    /// до первого вызова serialize/deserialize.
+    /// Тип Base должен объявлять виртуальную функцию
+    /// `TypeId serializationTypeId() const noexcept`, возвращающую идентификатор
+    /// фактического типа объекта.
+    /// @tparam Base  Базовый тип иерархии.
+    template <typename Base>
+    class PolymorphicRegistry
+    {
+    public:
+        /// Регистрирует производный тип Derived с идентификатором id.
+        /// Функции сериализации/десериализации Derived ищутся по ADL.
+        /// @tparam Derived  Производный тип. Должен быть конструируемым по умолчанию.
+        /// @param  id       Идентификатор типа. Не равен 0.
+        /// @return          true, если тип зарегистрирован; false, если id уже занят.
+        template <typename Derived>
+        static bool add(TypeId id);
+
+        /// Ищет запись по идентификатору типа.
+        /// @param  id  Идентификатор типа.
+        /// @return     Указатель на запись или nullptr, если тип не зарегистрирован.
+        static const PolymorphicEntry<Base> *find(TypeId id) noexcept;
+    };
+
+    /// Регистрирует производный тип при статической инициализации:
+    /// `template const bool Serialization::polymorphicRegistration<Shape, Circle, 1>;`
+    /// @tparam Base     Базовый тип иерархии.
+    /// @tparam Derived  Производный тип.
+    /// @tparam _id      Идентификатор типа.
+    template <typename Base, typename Derived, TypeId _id>
+    inline const bool polymorphicRegistration = PolymorphicRegistry<Base>::template add<Derived>(_id);
+
+    /// Сериализует полиморфный объект inValue во входной буфер: идентификатор фактического
+    /// типа (0 для нулевого указателя), затем сам объект функцией, зарегистрированной для этого типа.
+    /// Если тип не зарегистрирован или буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam Base          Базовый тип иерархии.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Объект для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @return               buffer со смещением.
+    template <typename Base, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::unique_ptr<Base> &inValue, std::endian targetEndian) noexcept;
+
+    /// Десериализует полиморфный объект из входного буфера в resultValue: по идентификатору типа
+    /// выбирается запись реестра, создаётся объект фактического типа и десериализуется
+    /// зарегистрированной функцией.
+    /// Если идентификатор не зарегистрирован, resultValue не изменяется,
+    /// а буфер возвращается без смещения.
+    /// @tparam Base          Базовый тип иерархии.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованный объект.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename Base, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::unique_ptr<Base> &resultValue, std::endian sourceEndian);
+
+    //*****************************************************************************
+    // Варианты (std::variant).
+    //*****************************************************************************
+
+    /// Сериализует вариант inValue во входной буфер: индекс активной альтернативы
+    /// (std::uint8_t при числе альтернатив не более 255, иначе std::uint16_t),
+    /// затем значение альтернативы функцией serialize, найденной по ADL.
+    /// Выбор функции для альтернативы выполняется по таблице функций, построенной
+    /// на этапе компиляции. Если вариант не содержит значения (valueless_by_exception)
+    /// или буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam Ts            Типы альтернатив.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Вариант для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @return               buffer со смещением.
+    template <typename... Ts, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::variant<Ts...> &inValue, std::endian targetEndian) noexcept;
+
+    /// Десериализует вариант из входного буфера в resultValue.
+    /// По прочитанному индексу из таблицы функций, построенной на этапе компиляции,
+    /// выбирается функция, которая создаёт альтернативу непосредственно в resultValue
+    /// (emplace) и десериализует её функцией deserialize, найденной по ADL, без цепочки
+    /// сравнений и без промежуточного создания другой альтернативы.
+    /// Если индекс не меньше sizeof...(Ts), resultValue не изменяется,
+    /// а буфер возвращается без смещения. Исключения, возникшие при создании
+    /// или десериализации альтернативы (например, std::bad_alloc), передаются вызывающему.
+    /// @tparam Ts            Типы альтернатив. Должны быть конструируемыми по умолчанию.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованный вариант.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename... Ts, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::variant<Ts...> &resultValue, std::endian sourceEndian);
+
+    //*****************************************************************************
+    // Описание размещения типов, генерируемое компилятором схем.
+    //*****************************************************************************
+
+    /// Вид поля в описании размещения.
+    enum class FieldKind
+    {
+        arithmetic,   ///< Арифметический тип.
+        enumeration,  ///< Перечисление.
+        string,       ///< Строка (префикс длины и байты).
+        array,        ///< Массив фиксированной длины.
+        vector,       ///< Массив переменной длины (префикс длины и элементы).
+        userType,     ///< Пользовательский тип со своим описанием размещения.
+        variant       ///< Вариант (индекс альтернативы и значение).
+    };
+
+    /// Смещение поля, которое нельзя вычислить на этапе компиляции,
+    /// так как ему предшествует поле переменного размера.
+    inline constexpr std::size_t dynamicOffset = static_cast<std::size_t>(-1);
+
+    /// Описание одного поля в бинарном представлении типа.
+    struct FieldDescriptor
+    {
+        std::string_view name;                  ///< Имя поля в схеме.
+        std::uint32_t id = 0;                   ///< Номер поля в схеме.
+        FieldKind kind = FieldKind::arithmetic; ///< Вид поля.
+        std::string_view typeName;              ///< Имя типа поля в схеме.
+        std::size_t offset = dynamicOffset;     ///< Смещение от начала типа или dynamicOffset.
+        std::size_t size = 0;                   ///< Размер в байтах; 0 для полей переменного размера.
+    };
+
+    /// Описание бинарного представления типа.
+    /// Используется сгенерированными функциями serialize/deserialize, а также
+    /// сторонними инструментами (перекодировщиками, построителями индексов смещений).
+    struct LayoutDescriptor
+    {
+        std::string_view name;                   ///< Полное имя типа в схеме.
+        std::uint32_t version = 0;               ///< Версия схемы.
+        std::span<const FieldDescriptor> fields; ///< Поля в порядке записи.
+        std::size_t fixedSize = 0;               ///< Размер префикса из полей фиксированного размера.
+        bool isFixedSize = false;                ///< Все поля имеют фиксированный размер.
+    };
+
+    // Компилятор схем для каждого типа UserType генерирует, помимо структуры и пары функций
+    // serialize/deserialize, функцию описания размещения, находимую по ADL:
+    //
+    //     constexpr const Serialization::LayoutDescriptor &layoutDescriptor(const UserType *) noexcept;
+
+    /// Возвращает описание размещения типа T, сгенерированное компилятором схем.
+    /// @tparam T  Тип, сгенерированный компилятором схем.
+    /// @return    Описание размещения.
+    template <typename T>
+    constexpr const LayoutDescriptor &layoutOf() noexcept;
+
+    //*****************************************************************************
+    // Формат MessagePack.
+    //*****************************************************************************
+
+    /// Политика формата MessagePack.
+    /// Передаётся в serialize/deserialize вместо порядка байтов: MessagePack всегда
+    /// использует порядок байтов big-endian.
+    struct MessagePackFormat
+    {
+    };
+
+    /// Политика формата MessagePack.
+    inline constexpr MessagePackFormat messagePack{};
+
+    /// Сериализует указанный объект inValue типа Т во входной буфер в формате MessagePack.
+    /// Встроенная поддержка: арифметические типы и перечисления (целые записываются в кратчайшей
+    /// форме, в том числе positive/negative fixint), bool, std::string и std::string_view
+    /// (fixstr/str, байты копируются векторно), std::vector, std::array (fixarray/array),
+    /// std::map и std::unordered_map (fixmap/map). Для пользовательских типов по ADL ищется
+    /// функция serialize(buffer, inValue, MessagePackFormat).
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T        Тип объекта.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  inValue  Объект для сериализации.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const T &inValue, MessagePackFormat format) noexcept;
+
+    /// Десериализует входной буфер в формате MessagePack в указанный объект resultValue типа Т.
+    /// Для контейнеров длина, записанная в заголовке массива или отображения, до резервирования
+    /// памяти сравнивается с остатком буфера: каждый элемент MessagePack занимает не менее
+    /// 1 байта, а пара ключ-значение - не менее 2 байт, поэтому длина массива должна быть
+    /// не больше остатка, а длина отображения - не больше остатка / 2. Если проверка пройдена,
+    /// память резервируется один раз по этой длине; иначе буфер возвращается без смещения,
+    /// поэтому короткий заголовок array32/map32 не может вызвать выделение большого объёма памяти.
+    /// Если тип значения в буфере не соответствует T или буфер недостаточен, буфер также
+    /// возвращается без смещения.
+    /// @tparam T            Тип объекта.
+    /// @tparam _extent      Extent входного буфера.
+    /// @param  buffer       Входной буфер.
+    /// @param  resultValue  Десериализованный выходной объект.
+    /// @param  format       Политика формата.
+    /// @return              buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T &resultValue, MessagePackFormat format);
+
+    /// Сериализует заголовок массива MessagePack из count элементов во входной буфер.
+    /// Используется в пользовательских функциях serialize для записи структуры как массива полей.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  count    Количество элементов.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <size_t _extent>
+    auto serializeArrayHeader(std::span<std::byte, _extent> buffer, std::uint32_t count, MessagePackFormat format) noexcept;
+
+    /// Десериализует заголовок массива MessagePack из входного буфера.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  count    Количество элементов.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <size_t _extent>
+    auto deserializeArrayHeader(std::span<const std::byte, _extent> buffer, std::uint32_t &count, MessagePackFormat format) noexcept;
+
+    /// Сериализует заголовок отображения MessagePack из count пар во входной буфер.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  count    Количество пар ключ-значение.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <size_t _extent>
+    auto serializeMapHeader(std::span<std::byte, _extent> buffer, std::uint32_t count, MessagePackFormat format) noexcept;
+
+    /// Десериализует заголовок отображения MessagePack из входного буфера.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  count    Количество пар ключ-значение.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <size_t _extent>
+    auto deserializeMapHeader(std::span<const std::byte, _extent> buffer, std::uint32_t &count, MessagePackFormat format) noexcept;
+
+    /// Сериализация групп переменных во входной буфер в формате MessagePack.
+    /// Переменные записываются подряд, без общего заголовка.
+    /// @tparam _extent  Extent входного буфера.
+    /// @tparam Args     Типы сериализуемых переменных в группе переменных.
+    /// @param  buffer   Входной буфер.
+    /// @param  format   Политика формата.
+    /// @param  args     Сериализуемые переменные.
+    /// @return          Неиспользуемая часть входного буфера.
+    template <std::size_t _extent, typename... Args>
+    constexpr auto serialize(std::span<std::byte, _extent> buffer, MessagePackFormat format, const Args &...args);
+
+    /// Десериализация групп переменных из входного буфера в формате MessagePack.
+    /// @tparam _extent  Extent входного буфера.
+    /// @tparam Args     Типы десериализуемых переменных в группе переменных.
+    /// @param  buffer   Входной буфер.
+    /// @param  format   Политика формата.
+    /// @param  args     Десериализуемые переменные.
+    /// @return          Неиспользуемая часть входного буфера.
+    template <std::size_t _extent, typename... Args>
+    constexpr auto deserialize(std::span<const std::byte, _extent> buffer, MessagePackFormat format, Args &&...args);
+
+    //*****************************************************************************
+    // Формат Protocol Buffers.
+    //*****************************************************************************
+
+    /// Политика формата Protocol Buffers (proto3, wire format).
+    /// Передаётся в serialize/deserialize вместо порядка байтов: числа фиксированного
+    /// размера в Protocol Buffers всегда записываются в порядке байтов little-endian.
+    struct ProtobufFormat
+    {
+    };
+
+    /// Политика формата Protocol Buffers.
+    inline constexpr ProtobufFormat protobuf{};
+
+    /// Кодирование значения поля Protocol Buffers.
+    enum class ProtobufEncoding
+    {
+        automatic,       ///< По типу поля: целые и перечисления - varint, float - fixed32,
+                         ///< double - fixed64, строки, std::vector и вложенные типы - lengthDelimited.
+        varint,          ///< int32/int64/uint32/uint64/bool/enum.
+        zigzag,          ///< sint32/sint64.
+        fixed32,         ///< fixed32/sfixed32/float.
+        fixed64,         ///< fixed64/sfixed64/double.
+        lengthDelimited  ///< string/bytes/вложенное сообщение/упакованное повторяющееся поле.
+    };
+
+    /// Аннотация поля пользовательского типа номером поля Protocol Buffers.
+    /// @tparam _number    Номер поля.
+    /// @tparam _member    Указатель на член пользовательского типа.
+    /// @tparam _encoding  Кодирование значения поля.
+    template <std::uint32_t _number, auto _member, ProtobufEncoding _encoding = ProtobufEncoding::automatic>
+    struct ProtobufField
+    {
+    };
+
+    // Пользовательский тип поддерживает формат Protocol Buffers, если в его пространстве
+    // имён объявлена функция, перечисляющая аннотированные поля:
+    //
+    //     constexpr auto protobufFields(const UserType *) noexcept
+    //     {
+    //         return std::tuple<Serialization::ProtobufField<1, &UserType::id>,
+    //                           Serialization::ProtobufField<2, &UserType::name>>{};
+    //     }
+
+    /// Сериализует указанный объект inValue пользовательского типа Т во входной буфер
+    /// в формате Protocol Buffers. Поля записываются в порядке возрастания номеров;
+    /// поля со значением по умолчанию не записываются. std::vector арифметических типов
+    /// записывается как упакованное повторяющееся поле.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T        Тип объекта. Должен иметь аннотацию protobufFields.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  inValue  Объект для сериализации.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const T &inValue, ProtobufFormat format) noexcept;
+
+    /// Десериализует сообщение Protocol Buffers из всего входного буфера в resultValue.
+    /// Декодер использует таблицу полей, построенную на этапе компиляции по protobufFields
+    /// и индексируемую номером поля; если поля идут в порядке возрастания номеров,
+    /// следующее поле проверяется первым без обращения к таблице.
+    /// Неизвестные поля пропускаются. При некорректных данных буфер возвращается без смещения.
+    /// @tparam T            Тип объекта. Должен иметь аннотацию protobufFields.
+    /// @tparam _extent      Extent входного буфера.
+    /// @param  buffer       Входной буфер, содержащий ровно одно сообщение.
+    /// @param  resultValue  Десериализованный выходной объект.
+    /// @param  format       Политика формата.
+    /// @return              buffer со смещением (пустой при успехе).
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T &resultValue, ProtobufFormat format);
+
+    //*****************************************************************************
+    // Формат CBOR.
+    //*****************************************************************************
+
+    /// Политика формата CBOR (RFC 8949).
+    /// Передаётся в serialize/deserialize вместо порядка байтов: CBOR всегда
+    /// использует порядок байтов big-endian.
+    struct CborFormat
+    {
+    };
+
+    /// Политика канонического (детерминированного) формата CBOR (RFC 8949, раздел 4.2.1):
+    /// целые и длины в кратчайшей форме, числа с плавающей точкой в кратчайшей форме,
+    /// представляющей значение точно (float16, затем float32, затем float64; NaN - как
+    /// float16 0x7e00), только определённые длины, ключи отображений отсортированы
+    /// по байтовому представлению. Используется для подписываемых данных.
+    struct CanonicalCborFormat
+    {
+    };
+
+    /// Политика формата CBOR.
+    inline constexpr CborFormat cbor{};
+
+    /// Политика канонического формата CBOR.
+    inline constexpr CanonicalCborFormat canonicalCbor{};
+
+    /// Строка фиксированной длины, используемая как параметр шаблона.
+    /// @tparam _size  Размер строки с завершающим нулём.
+    template <std::size_t _size>
+    struct FixedString
+    {
+        constexpr FixedString(const char (&value)[_size]) noexcept
+        {
+            for (std::size_t i = 0; i < _size; ++i)
+                data[i] = value[i];
+        }
+
+        char data[_size] = {};
+    };
+
+    /// Аннотация поля пользовательского типа ключом отображения CBOR.
+    /// @tparam _name    Ключ поля.
+    /// @tparam _member  Указатель на член пользовательского типа.
+    template <FixedString _name, auto _member>
+    struct CborField
+    {
+    };
+
+    // Пользовательский тип записывается как отображение CBOR, если в его пространстве
+    // имён объявлена функция, перечисляющая аннотированные поля:
+    //
+    //     constexpr auto cborFields(const UserType *) noexcept
+    //     {
+    //         return std::tuple<Serialization::CborField<"id", &UserType::id>,
+    //                           Serialization::CborField<"name", &UserType::name>>{};
+    //     }
+    //
+    // Порядок ключей в каноническом формате для такого типа вычисляется на этапе компиляции.
+
+    /// Сериализует указанный объект inValue типа Т во входной буфер в формате CBOR.
+    /// Встроенная поддержка: арифметические типы, перечисления, bool, строки, std::vector,
+    /// std::array, std::map, std::unordered_map и типы с аннотацией cborFields.
+    /// Для остальных пользовательских типов по ADL ищется функция serialize(buffer, inValue, CborFormat).
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T        Тип объекта.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  inValue  Объект для сериализации.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const T &inValue, CborFormat format) noexcept;
+
+    /// Сериализует указанный объект inValue типа Т во входной буфер в каноническом формате CBOR.
+    /// Для типов с аннотацией cborFields ключи записываются в порядке, вычисленном на этапе
+    /// компиляции. Ключи std::map и std::unordered_map сортируются непосредственно
+    /// в buffer, без выделения памяти. Числа float и double записываются как float16,
+    /// если значение представимо в нём точно, иначе как float32, если представимо точно,
+    /// иначе как float64.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T        Тип объекта.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  inValue  Объект для сериализации.
+    /// @param  format   Политика формата.
+    /// @return          buffer со смещением.
+    template <typename T, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const T &inValue, CanonicalCborFormat format) noexcept;
+
+    /// Десериализует входной буфер в формате CBOR в указанный объект resultValue типа Т.
+    /// Если тип значения в буфере не соответствует T или буфер недостаточен,
+    /// буфер возвращается без смещения.
+    /// @tparam T            Тип объекта.
+    /// @tparam _extent      Extent входного буфера.
+    /// @param  buffer       Входной буфер.
+    /// @param  resultValue  Десериализованный выходной объект.
+    /// @param  format       Политика формата.
+    /// @return              buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T &resultValue, CborFormat format);
+
+    /// Десериализует входной буфер в каноническом формате CBOR в указанный объект resultValue типа Т.
+    /// Дополнительно проверяется каноничность: целые, длины и числа с плавающей точкой
+    /// не в кратчайшей форме (например, float64, значение которого точно представимо в float32),
+    /// неопределённые длины и неотсортированные или повторяющиеся ключи считаются ошибкой,
+    /// и буфер возвращается без смещения.
+    /// @tparam T            Тип объекта.
+    /// @tparam _extent      Extent входного буфера.
+    /// @param  buffer       Входной буфер.
+    /// @param  resultValue  Десериализованный выходной объект.
+    /// @param  format       Политика формата.
+    /// @return              buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T &resultValue, CanonicalCborFormat format);
+
+    //*****************************************************************************
+    // Заголовок потока.
+    //*****************************************************************************
+
+    /// Форматы бинарного представления (битовая маска).
+    enum class Codec : std::uint16_t
+    {
+        none          = 0,
+        native        = 1 << 0,  ///< Формат функций serialize/deserialize с порядком байтов.
+        messagePack   = 1 << 1,  ///< MessagePackFormat.
+        protobuf      = 1 << 2,  ///< ProtobufFormat.
+        cbor          = 1 << 3,  ///< CborFormat.
+        canonicalCbor = 1 << 4   ///< CanonicalCborFormat.
+    };
+
+    constexpr Codec operator|(Codec left, Codec right) noexcept;
+    constexpr Codec operator&(Codec left, Codec right) noexcept;
+
+    /// Сигнатура заголовка потока.
+    inline constexpr std::uint32_t streamMagic = 0x53524C31;
+
+    /// Текущая версия формата заголовка потока.
+    inline constexpr std::uint16_t streamVersion = 1;
+
+    /// Размер заголовка потока в бинарном представлении в байтах.
+    inline constexpr std::size_t streamHeaderSize = 12;
+
+    /// Флаг заголовка потока: кадр завершается контрольной суммой CRC-32C.
+    inline constexpr std::uint8_t streamFlagChecksum = 1 << 0;
+
+    /// Самоописывающий заголовок потока или кадра.
+    /// Заголовок записывается в фиксированном формате размером streamHeaderSize байт,
+    /// не зависящем от платформы (значения std::endian зависят от реализации,
+    /// поэтому порядок байтов писателя записывается собственным кодом):
+    ///   байты 0-3   - magic (std::uint32_t, little-endian);
+    ///   байты 4-5   - version (std::uint16_t, little-endian);
+    ///   байт  6     - writerEndian: 0 - std::endian::little, 1 - std::endian::big;
+    ///   байт  7     - flags: набор флагов streamFlag*;
+    ///   байты 8-9   - codecs (std::uint16_t, little-endian);
+    ///   байты 10-11 - зарезервированы, равны 0.
+    struct StreamHeader
+    {
+        std::uint32_t magic = streamMagic;              ///< Сигнатура.
+        std::uint16_t version = streamVersion;          ///< Версия формата.
+        std::endian writerEndian = std::endian::native; ///< Порядок байтов данных после заголовка.
+        std::uint8_t flags = 0;                         ///< Флаги streamFlag*.
+        Codec codecs = Codec::native;                   ///< Форматы, используемые в потоке.
+    };
+
+    /// Сериализует заголовок потока inValue во входной буфер.
+    /// Если буфер меньше streamHeaderSize или inValue.writerEndian не равен
+    /// std::endian::little/std::endian::big, буфер возвращается без смещения.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  inValue  Заголовок для сериализации.
+    /// @return          buffer со смещением.
+    template <size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const StreamHeader &inValue) noexcept;
+
+    /// Десериализует заголовок потока из входного буфера в resultValue.
+    /// Если сигнатура не совпадает, версия больше streamVersion, байт порядка байтов
+    /// не равен 0 или 1, в flags установлены неизвестные флаги или зарезервированные байты
+    /// не равны 0, resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam _extent      Extent входного буфера.
+    /// @param  buffer       Входной буфер.
+    /// @param  resultValue  Десериализованный заголовок.
+    /// @return              buffer со смещением.
+    template <size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, StreamHeader &resultValue) noexcept;
+
+    /// Десериализация групп переменных из входного буфера с порядком байтов из заголовка потока.
+    /// Если header.writerEndian совпадает с std::endian::native, значения копируются
+    /// без перестановки байтов (memcpy), иначе - с перестановкой.
+    /// @tparam _extent  Extent входного буфера.
+    /// @tparam Args     Типы десериализуемых переменных в группе переменных.
+    /// @param  buffer   Входной буфер (данные после заголовка).
+    /// @param  header   Заголовок потока.
+    /// @param  args     Десериализуемые переменные.
+    /// @return          Неиспользуемая часть входного буфера.
+    template <std::size_t _extent, typename... Args>
+    constexpr auto deserialize(std::span<const std::byte, _extent> buffer, const StreamHeader &header, Args &&...args);
+
+    //*****************************************************************************
+    // Политики проверки границ буфера.
+    //*****************************************************************************
+
+    /// Ошибки сериализации/десериализации.
+    enum class SerializationError
+    {
+        bufferTooSmall,      ///< Размер буфера недостаточен.
+        invalidData,         ///< Некорректные данные (длина, тег или значение вне допустимого диапазона).
+        invalidUtf8,         ///< Некорректная последовательность UTF-8.
+        unknownTypeId,       ///< Идентификатор типа не зарегистрирован.
+        invalidVariantIndex, ///< Индекс альтернативы варианта вне диапазона.
+        invalidHeader,       ///< Некорректный заголовок потока.
+        budgetExceeded       ///< Превышен бюджет ресурсов десериализации.
+    };
+
+    /// Результат операции с политикой проверки границ CheckedBounds или HardenedBounds.
+    /// Использование Result (и всех функций, возвращающих его) требует C++23 (std::expected);
+    /// остальные функции библиотеки требуют C++20.
+    /// @tparam T  Тип результата при успехе.
+    template <typename T>
+    using Result = std::expected<T, SerializationError>;
+
+    /// Политика без проверок границ.
+    /// Предназначена для доверенных внутренних буферов, размер которых заведомо достаточен.
+    /// При недостаточном буфере поведение не определено.
+    struct UncheckedBounds
+    {
+    };
+
+    /// Политика с одной проверкой размера буфера на вызов верхнего уровня.
+    /// Перед сериализацией требуемый размер вычисляется функцией serializedSize;
+    /// при десериализации размер проверяется один раз для полей фиксированного размера
+    /// и по одному разу для каждого префикса длины.
+    struct CheckedBounds
+    {
+    };
+
+    /// Политика для недоверенных входных данных.
+    /// Дополнительно к CheckedBounds проверяются все значения, для которых допустима
+    /// не каждая комбинация битов: bool, перечисления (по функции isValid, найденной по ADL,
+    /// при её наличии), индексы вариантов, идентификаторы типов и строки (UTF-8).
+    struct HardenedBounds
+    {
+    };
+
+    /// Вычисляет размер бинарного представления группы переменных.
+    /// Для пользовательских типов по ADL ищется функция
+    /// `std::size_t serializedSize(const UserType &inValue) noexcept`.
+    /// @tparam Args  Типы переменных.
+    /// @param  args  Переменные.
+    /// @return       Размер бинарного представления в байтах.
+    template <typename... Args>
+    constexpr std::size_t serializedSize(const Args &...args) noexcept;
+
+    /// Сериализация групп переменных во входной буфер с политикой проверки границ Policy.
+    /// @tparam Policy        Политика: UncheckedBounds, CheckedBounds или HardenedBounds.
+    /// @tparam _extent       Extent входного буфера.
+    /// @tparam Args          Типы сериализуемых переменных в группе переменных.
+    /// @param  buffer        Входной буфер.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  args          Сериализуемые переменные.
+    /// @return               Неиспользуемая часть входного буфера для UncheckedBounds;
+    ///                       Result с неиспользуемой частью входного буфера или ошибкой
+    ///                       для CheckedBounds и HardenedBounds. При ошибке буфер не изменяется.
+    template <typename Policy, std::size_t _extent, typename... Args>
+    constexpr auto serialize(std::span<std::byte, _extent> buffer, std::endian targetEndian, const Args &...args) noexcept;
+
+    /// Десериализация групп переменных из входного буфера с политикой проверки границ Policy.
+    /// @tparam Policy        Политика: UncheckedBounds, CheckedBounds или HardenedBounds.
+    /// @tparam _extent       Extent входного буфера.
+    /// @tparam Args          Типы десериализуемых переменных в группе переменных.
+    /// @param  buffer        Входной буфер.
+    /// @param  sourceEndian  Порядок байт во входном буфере.
+    /// @param  args          Десериализуемые переменные.
+    /// @return               Неиспользуемая часть входного буфера для UncheckedBounds;
+    ///                       Result с неиспользуемой частью входного буфера или ошибкой
+    ///                       для CheckedBounds и HardenedBounds. При ошибке значения
+    ///                       переменных не определены.
+    template <typename Policy, std::size_t _extent, typename... Args>
+    constexpr auto deserialize(std::span<const std::byte, _extent> buffer, std::endian sourceEndian, Args &&...args);
+
+    //*****************************************************************************
+    // Ограничение ресурсов при десериализации недоверенных данных.
+    //*****************************************************************************
+
+    /// Ограничения ресурсов, расходуемых десериализацией.
+    /// Передаётся по ссылке. maxAllocatedBytes и maxElements уменьшаются на израсходованные
+    /// ресурсы, поэтому один бюджет может ограничивать несколько последовательных вызовов.
+    /// maxDepth не расходуется: он уменьшается при входе на уровень вложенности
+    /// и восстанавливается при выходе с него (в том числе при ошибке), так что после
+    /// каждого вызова верхнего уровня значение maxDepth прежнее.
+    struct ResourceBudget
+    {
+        std::size_t maxAllocatedBytes = 64u << 20; ///< Наибольший суммарный объём выделяемой памяти в байтах.
+        std::size_t maxDepth = 64;                 ///< Наибольшая глубина вложенности контейнеров и пользовательских типов.
+        std::size_t maxElements = 1u << 20;        ///< Наибольшее суммарное количество элементов контейнеров.
+    };
+
+    /// Десериализует входной буфер в указанный объект resultValue типа Т с ограничением ресурсов.
+    /// Перед выделением памяти под контейнер или строку префикс длины проверяется
+    /// по остатку входного буфера (каждый элемент занимает в буфере не менее одного байта
+    /// или не менее размера элемента фиксированного размера) и по остатку budget,
+    /// поэтому объём выделенной памяти ограничен размером входных данных.
+    /// Проверяются значения так же, как политикой HardenedBounds.
+    /// Для пользовательских типов по ADL ищется функция
+    /// deserialize(buffer, resultValue, sourceEndian, budget), которая должна передавать
+    /// budget во вложенные вызовы. Для типов, не являющихся тривиально копируемыми
+    /// (и потому, возможно, владеющих памятью: строки, контейнеры), такая функция
+    /// обязательна - её отсутствие приводит к ошибке компиляции (static_assert).
+    /// Для тривиально копируемых пользовательских типов, которые не выделяют память,
+    /// при её отсутствии используется deserialize(buffer, resultValue, sourceEndian)
+    /// с учётом только глубины вложенности.
+    /// @tparam T             Тип объекта.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованный выходной объект.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  budget        Остаток ресурсов; уменьшается на израсходованные память и элементы.
+    /// @return               Result с неиспользуемой частью входного буфера или ошибкой
+    ///                       (SerializationError::budgetExceeded при исчерпании budget).
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, T &resultValue, std::endian sourceEndian, ResourceBudget &budget);
+
+    /// Десериализация групп переменных из входного буфера с ограничением ресурсов.
+    /// @tparam _extent       Extent входного буфера.
+    /// @tparam Args          Типы десериализуемых переменных в группе переменных.
+    /// @param  buffer        Входной буфер.
+    /// @param  sourceEndian  Порядок байт во входном буфере.
+    /// @param  budget        Остаток ресурсов; уменьшается на израсходованные память и элементы.
+    /// @param  args          Десериализуемые переменные.
+    /// @return               Result с неиспользуемой частью входного буфера или ошибкой.
+    template <std::size_t _extent, typename... Args>
+    constexpr auto deserialize(std::span<const std::byte, _extent> buffer, std::endian sourceEndian, ResourceBudget &budget, Args &&...args);
+
+    //*****************************************************************************
+    // Структурная проверка недоверенных буферов.
+    //*****************************************************************************
+
+    // Для поддержки проверки пользовательский тип объявляет (в том же пространстве имён)
+    // функцию, проверяющую своё бинарное представление без создания объекта:
+    //
+    //     template<size_t _extent>
+    //     Serialization::Result<std::span<const std::byte, std::dynamic_extent>>
+    //     verify(std::span<const std::byte, _extent> buffer, const UserType *, std::endian sourceEndian) noexcept;
+    //
+    // Функция возвращает остаток буфера после представления типа или ошибку.
+
+    /// Проверяет, что входной буфер начинается с корректного бинарного представления типа T:
+    /// все префиксы длины, индексы вариантов, идентификаторы типов и значения, проверяемые
+    /// политикой HardenedBounds, находятся в допустимых пределах. Объекты не создаются
+    /// и память не выделяется; буфер просматривается один раз последовательно,
+    /// массивы элементов фиксированного размера проверяются одним сравнением длины.
+    /// После успешной проверки буфер можно десериализовать с политикой UncheckedBounds.
+    /// @tparam T             Тип объекта.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               Result с размером бинарного представления в байтах или ошибкой.
+    template <typename T, size_t _extent>
+    Result<std::size_t> verify(std::span<const std::byte, _extent> buffer, std::endian sourceEndian) noexcept;
+
+    // Для проверки позиционно-независимого размещения каждый тип, содержащий RelativePtr,
+    // RelativeArray или другие такие типы, объявляет (в том же пространстве имён) функцию,
+    // перечисляющую эти члены:
+    //
+    //     constexpr auto relativeMembers(const UserType *) noexcept
+    //     {
+    //         return std::tuple{&UserType::next, &UserType::items, &UserType::nested};
+    //     }
+    //
+    // Члены остальных типов (арифметические типы, перечисления) не проверяются, так как для них
+    // допустима любая комбинация битов. Тип без relativeMembers считается не содержащим ссылок.
+
+    /// Размер вспомогательной памяти для verifyInPlace.
+    /// Память содержит карту посещённых объектов: по одному байту тега типа на 8 байт буфера
+    /// (типы с relativeMembers содержат std::int64_t и выровнены не менее чем по 8 байт).
+    /// @param  bufferSize  Размер проверяемого буфера в байтах.
+    /// @return             Размер вспомогательной памяти в байтах, (bufferSize + 7) / 8.
+    constexpr std::size_t verifyInPlaceScratchSize(std::size_t bufferSize) noexcept;
+
+    /// Проверяет позиционно-независимое размещение с корневым объектом типа T:
+    /// заголовок, а также то, что все RelativePtr и RelativeArray, достижимые из корневого
+    /// объекта через relativeMembers, указывают внутрь buffer и выровнены по alignof
+    /// целевого типа. RelativeArray проверяется по всему диапазону: вычисление
+    /// offset + size * sizeof(T) не должно переполняться (size <= остаток буфера / sizeof(T)),
+    /// и весь диапазон должен находиться внутри buffer.
+    /// Обход выполняется в глубину. Для каждого объекта, на который указывает RelativePtr,
+    /// и каждого элемента RelativeArray в scratch по его адресу записывается тег типа:
+    /// 1 + индекс типа в списке типов, достижимых из T через relativeMembers (не более 255
+    /// типов, иначе ошибка компиляции). Объект с уже записанным тем же тегом повторно
+    /// не обходится, поэтому разделяемые объекты проверяются один раз, а циклы не приводят
+    /// к зацикливанию. Если по адресу уже записан тег другого типа (например, RelativePtr<Small>
+    /// и RelativePtr<Big> на один адрес), возвращается SerializationError::invalidData.
+    /// Члены, вложенные в объект непосредственно (не через ссылку), тегами не отмечаются
+    /// и проверяются рекурсивно при каждой проверке содержащего их объекта, в том числе
+    /// вложенный член по смещению 0, адрес которого совпадает с адресом объекта.
+    /// Функция не выделяет память: карта тегов занимает verifyInPlaceScratchSize(buffer.size())
+    /// байт, а глубина рекурсии ограничена maxDepth.
+    /// После успешной проверки inPlaceRoot<T>(buffer) можно использовать для недоверенных данных.
+    /// @tparam T         Тип корневого объекта.
+    /// @param  buffer    Входной буфер, созданный InPlaceBuilder.
+    /// @param  scratch   Вспомогательная память размером не менее verifyInPlaceScratchSize(buffer.size()).
+    /// @param  maxDepth  Наибольшая длина цепочки ссылок от корневого объекта.
+    /// @return           Result без значения или ошибка: SerializationError::bufferTooSmall,
+    ///                   если scratch недостаточен; SerializationError::invalidData, если ссылка
+    ///                   указывает за пределы buffer, не выровнена, объект по одному адресу
+    ///                   используется как объекты разных типов или длина цепочки больше maxDepth.
+    template <typename T>
+    Result<void> verifyInPlace(std::span<const std::byte> buffer, std::span<std::byte> scratch, std::size_t maxDepth = 64) noexcept;
+
+    //*****************************************************************************
+    // Сериализация массивов одним блоком.
+    //*****************************************************************************
+
+    /// Параметры записи в обход кэша (non-temporal stores).
+    struct StreamingStores
+    {
+        /// Размер массива в байтах, начиная с которого используется запись в обход кэша.
+        /// Меньшие массивы записываются обычным образом.
+        std::size_t threshold = 4u << 20;
+    };
+
+    /// Сериализует массив values арифметических типов или перечислений во входной буфер одним блоком,
+    /// без префикса длины. Принимает std::span как с константными, так и с изменяемыми элементами
+    /// (элементы только читаются), поэтому массив можно передать как std::span(container).
+    /// При совпадении targetEndian с std::endian::native элементы копируются
+    /// без перестановки байтов (memcpy), иначе перестановка байтов выполняется векторно.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T              Тип элементов (возможно, const). Арифметический тип или перечисление.
+    /// @tparam _extent        Extent входного буфера.
+    /// @tparam _valuesExtent  Extent массива.
+    /// @param  buffer         Входной буфер.
+    /// @param  values         Массив для сериализации.
+    /// @param  targetEndian   Порядок байтов в результате.
+    /// @return                buffer со смещением.
+    template <typename T, size_t _extent, size_t _valuesExtent>
+    auto serialize(std::span<std::byte, _extent> buffer, std::span<T, _valuesExtent> values, std::endian targetEndian) noexcept;
+
+    /// Сериализует массив values во входной буфер одним блоком, как перегрузка без stores,
+    /// но при размере массива не меньше stores.threshold записывает данные в обход кэша
+    /// (movntdq/vmovntdq на x86-64, иначе обычная запись) и завершает запись барьером sfence,
+    /// чтобы выходной буфер не вытеснял из кэша рабочие данные.
+    /// @tparam T              Тип элементов (возможно, const). Арифметический тип или перечисление.
+    /// @tparam _extent        Extent входного буфера.
+    /// @tparam _valuesExtent  Extent массива.
+    /// @param  buffer         Входной буфер.
+    /// @param  values         Массив для сериализации.
+    /// @param  targetEndian   Порядок байтов в результате.
+    /// @param  stores         Параметры записи в обход кэша.
+    /// @return                buffer со смещением.
+    template <typename T, size_t _extent, size_t _valuesExtent>
+    auto serialize(std::span<std::byte, _extent> buffer, std::span<T, _valuesExtent> values, std::endian targetEndian, StreamingStores stores) noexcept;
+
+    /// Десериализует из входного буфера values.size() элементов в массив values одним блоком.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T              Тип элементов. Арифметический тип или перечисление.
+    /// @tparam _extent        Extent входного буфера.
+    /// @tparam _valuesExtent  Extent массива.
+    /// @param  buffer         Входной буфер.
+    /// @param  values         Десериализованный массив.
+    /// @param  sourceEndian   Порядок байтов во входном буфере.
+    /// @return                buffer со смещением.
+    template <typename T, size_t _extent, size_t _valuesExtent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::span<T, _valuesExtent> values, std::endian sourceEndian) noexcept;
+
+    //*****************************************************************************
+    // Динамические массивы (std::vector).
+    //*****************************************************************************
+
+    /// Параметры программной предвыборки при десериализации массивов.
+    struct PrefetchDistance
+    {
+        std::size_t inputBytes = 1024; ///< Расстояние предвыборки во входном буфере в байтах; 0 - без предвыборки.
+        std::size_t elements = 8;      ///< Расстояние предвыборки элементов результата; 0 - без предвыборки.
+    };
+
+    /// Сериализует массив inValue во входной буфер: количество элементов (std::uint64_t),
+    /// затем элементы. Элементы арифметических типов (кроме bool) и перечислений записываются
+    /// одним блоком, элементы остальных типов - функцией serialize, найденной по ADL.
+    /// std::vector<bool> хранит элементы упакованными по битам и не может быть записан одним
+    /// блоком, поэтому его элементы записываются поэлементно, по одному байту (0 или 1) на элемент.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T             Тип элементов.
+    /// @tparam Allocator     Распределитель памяти массива.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  inValue       Массив для сериализации.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @return               buffer со смещением.
+    template <typename T, typename Allocator, size_t _extent>
+    auto serialize(std::span<std::byte, _extent> buffer, const std::vector<T, Allocator> &inValue, std::endian targetEndian) noexcept;
+
+    /// Десериализует массив из входного буфера в resultValue.
+    /// Перед резервированием памяти количество элементов проверяется по остатку входного буфера
+    /// без умножения, которое могло бы переполниться при недоверенном количестве:
+    /// count <= остаток / elementSize, где elementSize - наименьший размер элемента в буфере
+    /// (sizeof(T) для арифметических типов и перечислений, иначе 1 байт). Иначе resultValue
+    /// не изменяется, а буфер возвращается без смещения, поэтому некорректный префикс длины
+    /// не приводит к выделению памяти, превышающей размер входных данных.
+    /// Память резервируется один раз по проверенному количеству элементов; элементы арифметических
+    /// типов (кроме bool) и перечислений читаются одним блоком, элементы std::vector<bool> -
+    /// поэлементно по одному байту, элементы остальных типов - функцией deserialize,
+    /// найденной по ADL.
+    /// @tparam T             Тип элементов. Должен быть конструируемым по умолчанию.
+    /// @tparam Allocator     Распределитель памяти массива.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованный массив.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @return               buffer со смещением.
+    template <typename T, typename Allocator, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::vector<T, Allocator> &resultValue, std::endian sourceEndian);
+
+    /// Десериализует массив пользовательских типов из входного буфера в resultValue
+    /// с той же проверкой количества элементов, что и перегрузка без prefetch,
+    /// и с программной предвыборкой: перед десериализацией очередного элемента выполняется
+    /// предвыборка входного буфера на prefetch.inputBytes вперёд, а также элемента результата
+    /// на prefetch.elements позиций вперёд и памяти, на которую он ссылается
+    /// (по функции prefetch(const UserType &), найденной по ADL, при её наличии).
+    /// Расстояния подбираются под конкретную платформу и размер элементов.
+    /// @tparam T             Тип элементов. Должен быть конструируемым по умолчанию.
+    /// @tparam Allocator     Распределитель памяти массива.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер.
+    /// @param  resultValue   Десериализованный массив.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  prefetch      Параметры предвыборки.
+    /// @return               buffer со смещением.
+    template <typename T, typename Allocator, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::vector<T, Allocator> &resultValue, std::endian sourceEndian, PrefetchDistance prefetch);
+
+    //*****************************************************************************
+    // Выровненное размещение массивов.
+    //*****************************************************************************
+
+    /// Параметры выровненного размещения массивов.
+    struct AlignedLayout
+    {
+        const std::byte *origin = nullptr; ///< Начало буфера, относительно которого выравниваются массивы.
+        std::size_t alignment = 64;        ///< Выравнивание элементов массива: 16, 32 или 64 байта.
+    };
+
+    /// Сериализует массив values во входной буфер в выровненном размещении:
+    /// количество элементов (std::uint64_t), байт с размером заполнителя, заполнитель
+    /// из нулевых байтов и элементы, начало которых выровнено по layout.alignment
+    /// относительно layout.origin. Байт размера заполнителя позволяет прочитать массив
+    /// и без учёта выравнивания; дополнительный расход - не более layout.alignment байт.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T              Тип элементов (возможно, const). Арифметический тип или перечисление.
+    /// @tparam _extent        Extent входного буфера.
+    /// @tparam _valuesExtent  Extent массива.
+    /// @param  buffer         Входной буфер. Должен находиться внутри буфера, начинающегося с layout.origin.
+    /// @param  values         Массив для сериализации.
+    /// @param  targetEndian   Порядок байтов в результате.
+    /// @param  layout         Параметры выровненного размещения.
+    /// @return                buffer со смещением.
+    template <typename T, size_t _extent, size_t _valuesExtent>
+    auto serialize(std::span<std::byte, _extent> buffer, std::span<T, _valuesExtent> values, std::endian targetEndian, AlignedLayout layout) noexcept;
+
+    /// Десериализует массив в выровненном размещении в представление resultValue без копирования.
+    /// Если входной буфер размещён по адресу, выровненному по layout.alignment, элементы
+    /// resultValue выровнены так же и допускают выровненные векторные загрузки.
+    /// Если sourceEndian отличается от std::endian::native или элементы не выровнены
+    /// по alignof(T), resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam T             Тип элементов. Арифметический тип или перечисление.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен существовать, пока используется resultValue.
+    /// @param  resultValue   Представление десериализованного массива.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  layout        Параметры выровненного размещения.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<const std::byte, _extent> buffer, std::span<const T> &resultValue, std::endian sourceEndian, AlignedLayout layout) noexcept;
+
+    /// Десериализует массив в выровненном размещении в изменяемое представление resultValue
+    /// без копирования, что позволяет выполнять вычисления непосредственно в буфере.
+    /// Если sourceEndian отличается от std::endian::native, порядок байтов элементов
+    /// меняется непосредственно в buffer. Если элементы не выровнены по alignof(T),
+    /// resultValue не изменяется, а буфер возвращается без смещения.
+    /// @tparam T             Тип элементов. Арифметический тип или перечисление.
+    /// @tparam _extent       Extent входного буфера.
+    /// @param  buffer        Входной буфер. Должен существовать, пока используется resultValue.
+    /// @param  resultValue   Изменяемое представление десериализованного массива.
+    /// @param  sourceEndian  Порядок байтов во входном буфере.
+    /// @param  layout        Параметры выровненного размещения.
+    /// @return               buffer со смещением.
+    template <typename T, size_t _extent>
+    auto deserialize(std::span<std::byte, _extent> buffer, std::span<T> &resultValue, std::endian sourceEndian, AlignedLayout layout) noexcept;
+
+    //*****************************************************************************
+    // Буферы и параллельная сериализация.
+    //*****************************************************************************
+
+    /// Политика размещения страниц буфера по узлам NUMA.
+    enum class NumaPolicy
+    {
+        none,       ///< Размещение по умолчанию операционной системы.
+        local,      ///< Страницы размещаются на узле потока, первым обратившегося к ним (first touch).
+        interleave, ///< Страницы размещаются поочерёдно на всех узлах.
+        bind        ///< Страницы размещаются на узле BufferOptions::numaNode.
+    };
+
+    /// Использование больших страниц (2 МиБ) для памяти буфера.
+    enum class HugePages
+    {
+        none,        ///< Обычные страницы.
+        transparent, ///< Запрос прозрачных больших страниц (madvise(MADV_HUGEPAGE)).
+        reserved     ///< Выделение из резерва больших страниц (MAP_HUGETLB); при нехватке резерва -
+                     ///< как HugePages::transparent.
+    };
+
+    /// Статистика использования больших страниц.
+    struct HugePageStatistics
+    {
+        std::size_t totalBytes = 0;    ///< Объём памяти в байтах.
+        std::size_t hugePageBytes = 0; ///< Объём памяти, фактически размещённой в больших страницах, в байтах.
+    };
+
+    /// Параметры выделения памяти буфера.
+    struct BufferOptions
+    {
+        NumaPolicy numaPolicy = NumaPolicy::none; ///< Политика размещения страниц.
+        int numaNode = -1;                        ///< Узел NUMA для NumaPolicy::bind.
+        HugePages hugePages = HugePages::none;    ///< Использование больших страниц.
+    };
+
+    /// Буфер, память которого выделяется страницами непосредственно у операционной системы
+    /// (mmap/VirtualAlloc) с учётом BufferOptions. Политики NUMA применяются через libnuma
+    /// (mbind/set_mempolicy) при её наличии и игнорируются в противном случае.
+    /// Начало буфера выровнено по размеру страницы.
+    class Buffer
+    {
+    public:
+        /// Создаёт пустой буфер.
+        Buffer() noexcept;
+
+        /// Выделяет буфер размером не менее size байт.
+        /// @param  size     Размер буфера в байтах.
+        /// @param  options  Параметры выделения памяти.
+        explicit Buffer(std::size_t size, const BufferOptions &options = {});
+
+        Buffer(Buffer &&other) noexcept;
+        Buffer &operator=(Buffer &&other) noexcept;
+        ~Buffer();
+
+        /// @return  Память буфера.
+        std::span<std::byte> span() noexcept;
+
+        /// @return  Память буфера.
+        std::span<const std::byte> span() const noexcept;
+
+        /// @return  Размер буфера в байтах.
+        std::size_t size() const noexcept;
+
+        /// Возвращает статистику использования больших страниц буфером
+        /// (по /proc/self/smaps для прозрачных больших страниц).
+        /// @return  Статистика использования больших страниц.
+        HugePageStatistics hugePageStatistics() const;
+    };
+
+    /// Пул буферов одинакового размера, позволяющий не выделять память для каждого сообщения.
+    /// В отличие от остальной библиотеки, acquire и release потокобезопасны.
+    /// При NumaPolicy::local пул хранит освобождённые буферы отдельно для каждого узла NUMA
+    /// и выдаёт потоку буфер, страницы которого размещены на его узле.
+    class BufferPool
+    {
+    public:
+        /// Создаёт пул буферов.
+        /// @param  bufferSize  Размер каждого буфера в байтах.
+        /// @param  options     Параметры выделения памяти буферов.
+        explicit BufferPool(std::size_t bufferSize, const BufferOptions &options = {});
+
+        /// Выдаёт буфер из пула или выделяет новый.
+        /// @return  Буфер размером bufferSize.
+        Buffer acquire();
+
+        /// Возвращает буфер в пул.
+        /// @param  buffer  Буфер, ранее выданный acquire.
+        void release(Buffer &&buffer) noexcept;
+
+        /// Возвращает суммарную статистику использования больших страниц буферами пула.
+        /// @return  Статистика использования больших страниц.
+        HugePageStatistics hugePageStatistics() const;
+    };
+
+    /// Файл, отображённый в память только для чтения.
+    /// Используется для доступа без копирования к позиционно-независимому размещению,
+    /// плоским отображениям и хеш-таблицам. Большие страницы для отображения файла
+    /// запрашиваются через madvise(MADV_HUGEPAGE) и используются, только если их поддерживает
+    /// файловая система; HugePages::reserved для файлов трактуется как HugePages::transparent.
+    class MappedFile
+    {
+    public:
+        /// Отображает файл path в память.
+        /// При ошибке открытия или отображения файла создаётся пустой объект.
+        /// @param  path       Путь к файлу.
+        /// @param  hugePages  Использование больших страниц.
+        explicit MappedFile(const char *path, HugePages hugePages = HugePages::none);
+
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+        ~MappedFile();
+
+        /// @return  Содержимое файла или пустой span, если файл не отображён.
+        std::span<const std::byte> span() const noexcept;
+
+        /// @return  Статистика использования больших страниц отображением.
+        HugePageStatistics hugePageStatistics() const;
+    };
+
+    /// Параллельно сериализует массив values во входной буфер.
+    /// Смещения элементов вычисляются заранее по serializedSize, после чего массив делится
+    /// на workerCount частей, и каждый поток записывает свою часть.
+    /// Размещение страниц задаётся options.numaPolicy и options.numaNode (options.hugePages
+    /// не используется). Если options.numaPolicy не равна NumaPolicy::none, она заменяет
+    /// политику, с которой был выделен буфер (например, BufferOptions объекта Buffer):
+    /// до записи для страниц buffer вызывается mbind с этой политикой. При NumaPolicy::none
+    /// сохраняется политика, с которой был выделен буфер. При NumaPolicy::local
+    /// каждый поток первым обращается к страницам своей части, поэтому они размещаются
+    /// на его узле и запись не затрагивает удалённую память. При NumaPolicy::interleave
+    /// страницы буфера размещаются поочерёдно на всех узлах, а при NumaPolicy::bind -
+    /// на узле options.numaNode.
+    /// Результат совпадает с последовательной сериализацией элементов values.
+    /// Если буфер недостаточен, буфер возвращается без смещения.
+    /// @tparam T              Тип элементов (может быть const).
+    /// @tparam _extent        Extent входного буфера.
+    /// @tparam _valuesExtent  Extent массива.
+    /// @param  buffer         Входной буфер. Для NumaPolicy::local к его страницам не должно быть обращений до вызова.
+    /// @param  values         Массив для сериализации.
+    /// @param  targetEndian   Порядок байтов в результате.
+    /// @param  workerCount    Количество потоков; 0 - по количеству аппаратных потоков.
+    /// @param  options        Политика размещения страниц и узел NUMA.
+    /// @return                buffer со смещением.
+    template <typename T, size_t _extent, size_t _valuesExtent>
+    auto serializeParallel(std::span<std::byte, _extent> buffer, std::span<T, _valuesExtent> values, std::endian targetEndian, std::size_t workerCount, const BufferOptions &options);
+
+    //*****************************************************************************
+    // Запись в цепочку сегментов.
+    //*****************************************************************************
+
+    /// Писатель в цепочку сегментов фиксированного размера.
+    /// В отличие от одного непрерывного растущего буфера, при увеличении сообщения
+    /// добавляется новый сегмент, и ранее записанные данные не копируются.
+    /// Результат доступен как список сегментов (например, для writev) или как
+    /// непрерывная копия по запросу.
+    class ChainedWriter
+    {
+    public:
+        /// Создаёт писатель, выделяющий сегменты самостоятельно.
+        /// @param  segmentSize  Размер сегмента в байтах.
+        /// @param  options      Параметры выделения памяти сегментов.
+        explicit ChainedWriter(std::size_t segmentSize = 64u << 10, const BufferOptions &options = {});
+
+        /// Создаёт писатель, получающий сегменты из пула; размер сегмента равен размеру буферов пула.
+        /// Сегменты возвращаются в пул при вызове clear или уничтожении писателя.
+        /// @param  pool  Пул буферов. Должен существовать дольше писателя.
+        explicit ChainedWriter(BufferPool &pool);
+
+        ChainedWriter(ChainedWriter &&other) noexcept;
+        ChainedWriter &operator=(ChainedWriter &&other) noexcept;
+        ~ChainedWriter();
+
+        /// Возвращает непрерывную свободную часть текущего сегмента размером не менее size байт,
+        /// начиная новый сегмент, если в текущем недостаточно места.
+        /// @param  size  Требуемый размер в байтах. Не больше размера сегмента.
+        /// @return       Свободная часть сегмента.
+        std::span<std::byte> reserve(std::size_t size);
+
+        /// Отмечает size байт, начиная с последнего результата reserve, как записанные.
+        /// @param  size  Количество записанных байтов.
+        void commit(std::size_t size) noexcept;
+
+        /// Записывает data в конец цепочки, при необходимости разделяя данные между сегментами.
+        /// @param  data  Данные для записи.
+        void write(std::span<const std::byte> data);
+
+        /// @return  Общий размер записанных данных в байтах.
+        std::size_t size() const noexcept;
+
+        /// @return  Заполненные части сегментов в порядке записи.
+        std::vector<std::span<const std::byte>> segments() const;
+
+        /// @return  Заполненные части сегментов в виде, пригодном для writev/sendmsg.
+        std::vector<::iovec> iovecs() const;
+
+        /// Копирует записанные данные в buffer одним непрерывным блоком.
+        /// @param  buffer  Выходной буфер размером не менее size().
+        /// @return         Заполненная часть buffer или пустой span, если буфер недостаточен.
+        std::span<std::byte> flatten(std::span<std::byte> buffer) const noexcept;
+
+        /// Удаляет записанные данные, сохраняя первый сегмент для повторного использования.
+        void clear() noexcept;
+    };
+
+    /// Сериализация групп переменных в цепочку сегментов.
+    /// Размер каждой переменной определяется заранее функцией serializedSize, поэтому
+    /// для пользовательских типов обязательна функция serializedSize, найденная по ADL
+    /// (её отсутствие приводит к ошибке компиляции).
+    /// Каждая переменная сериализуется обычной функцией serialize (встроенной или найденной
+    /// по ADL) непосредственно в текущий сегмент, если её размер помещается в его остаток.
+    /// Только переменная, пересекающая границу сегмента, сериализуется во вспомогательный
+    /// буфер (на стеке для небольших значений) и затем копируется в сегменты функцией
+    /// ChainedWriter::write.
+    /// Единственная проверка результата: функция serialize переменной должна сместить буфер
+    /// ровно на serializedSize байт (значения нулевого размера, например пустой массив
+    /// std::span, допустимы). В противном случае (например, вариант в состоянии
+    /// valueless_by_exception, для которого serialize не смещает буфер, или пользовательская
+    /// функция serializedSize, не согласованная с serialize) возвращается ошибка,
+    /// а записанные этим вызовом данные удаляются из writer.
+    /// @tparam Args          Типы сериализуемых переменных в группе переменных.
+    /// @param  writer        Писатель в цепочку сегментов.
+    /// @param  targetEndian  Порядок байтов в результате.
+    /// @param  args          Сериализуемые переменные.
+    /// @return               Result без значения или ошибка SerializationError::invalidData.
+    template <typename... Args>
+    Result<void> serialize(ChainedWriter &writer, std::endian targetEndian, const Args &...args);
+
+    //*****************************************************************************
+    // Чтение из последовательности сегментов.
+    //*****************************************************************************
+
+    /// Размер вспомогательного буфера на стеке для значений, пересекающих границу сегментов.
+    inline constexpr std::size_t segmentBounceSize = 256;
+
+    /// Читатель последовательности несмежных входных сегментов
+    /// (например, цепочки буферов, полученных из сети).
+    /// Не копирует сегменты; сегменты должны существовать, пока используется читатель.
+    class SegmentedReader
+    {
+    public:
+        /// Создаёт читатель последовательности сегментов.
+        /// @param  segments  Входные сегменты в порядке следования данных.
+        explicit SegmentedReader(std::span<const std::span<const std::byte>> segments) noexcept;
+
+        /// @return  Непрочитанная часть текущего сегмента.
+        std::span<const std::byte> current() const noexcept;
+
+        /// Пропускает size байт, при необходимости переходя к следующим сегментам.
+        /// @param  size  Количество байтов. Не больше remaining().
+        void advance(std::size_t size) noexcept;
+
+        /// Копирует data.size() байт в data, при необходимости переходя к следующим сегментам.
+        /// @param  data  Выходной буфер.
+        /// @return       Количество скопированных байтов (меньше data.size() в конце данных).
+        std::size_t read(std::span<std::byte> data) noexcept;
+
+        /// @return  Количество непрочитанных байтов во всех сегментах.
+        std::size_t remaining() const noexcept;
+    };
+
+    /// Десериализация групп переменных из последовательности сегментов.
+    /// Каждая переменная десериализуется обычной функцией deserialize (встроенной или найденной
+    /// по ADL) непосредственно из текущего сегмента с политикой CheckedBounds.
+    /// Только если при этом возвращена ошибка SerializationError::bufferTooSmall (переменная
+    /// пересекает границу сегмента), размер переменной определяется повторными попытками:
+    /// во вспомогательный буфер на стеке копируются min(reader.remaining(), segmentBounceSize)
+    /// байт, и десериализация повторяется; при повторной ошибке bufferTooSmall данные
+    /// копируются в выделенный буфер, размер которого удваивается при каждой попытке,
+    /// пока десериализация не завершится успешно или не будут скопированы все оставшиеся
+    /// данные (тогда возвращается bufferTooSmall). Благодаря удвоению суммарный объём
+    /// копирования пропорционален размеру переменной. После успеха reader смещается
+    /// на фактически использованное количество байтов.
+    /// Массив std::span<T, N> (десериализация массива одним блоком) копируется в массив
+    /// вызывающего, и его размер в байтах (values.size() * sizeof(T)) известен заранее,
+    /// поэтому при пересечении границы сегмента он копируется из сегментов непосредственно
+    /// в values (с перестановкой байтов при необходимости) без повторных попыток.
+    /// Переменные, десериализуемые в представления, указывающие на входные данные
+    /// (std::string_view, FlatMapView, HashTableView), никогда не десериализуются
+    /// через вспомогательный буфер, так как представление указывало бы на освобождённую память:
+    /// если такая переменная пересекает границу сегмента, возвращается ошибка
+    /// SerializationError::invalidData.
+    /// @tparam Args          Типы десериализуемых переменных в группе переменных.
+    /// @param  reader        Читатель последовательности сегментов.
+    /// @param  sourceEndian  Порядок байт во входном буфере.
+    /// @param  args          Десериализуемые переменные.
+    /// @return               Result без значения или ошибка. При ошибке позиция reader не определена.
+    template <typename... Args>
+    Result<void> deserialize(SegmentedReader &reader, std::endian sourceEndian, Args &&...args);
+
+    //*****************************************************************************
+    // Пакетная передача сообщений.
+    //*****************************************************************************
+
+    /// Параметры пакета сообщений.
+    struct BatchOptions
+    {
+        std::size_t maxBytes = 64u << 10;        ///< Наибольший размер кадра в байтах.
+        std::size_t maxMessages = 1024;          ///< Наибольшее количество сообщений в кадре.
+        std::chrono::microseconds maxDelay{500}; ///< Наибольшая задержка первого сообщения в кадре.
+        bool checksum = true;                    ///< Записывать контрольную сумму CRC-32C кадра
+                                                 ///< (отмечается флагом streamFlagChecksum в заголовке).
+    };
+
+    /// Размер полей кадра пакета сообщений между заголовком потока и сообщениями в байтах.
+    inline constexpr std::size_t batchCountsSize = 8;
+
+    /// Кодировщик пакета сообщений.
+    /// Накапливает небольшие сообщения в одном кадре. Заголовок и контрольная сумма
+    /// записываются один раз на кадр, а не на каждое сообщение. Кадр имеет следующий формат;
+    /// служебные поля кадра всегда записываются в little-endian независимо от targetEndian,
+    /// а данные сообщений - в порядке байтов targetEndian (header.writerEndian):
+    ///   байты 0-11    - заголовок StreamHeader: writerEndian равен targetEndian, в flags
+    ///                   установлен streamFlagChecksum, если options.checksum;
+    ///   байты 12-15   - количество сообщений N (std::uint32_t, little-endian);
+    ///   байты 16-19   - размер данных D в байтах: сумма по всем сообщениям длины префикса
+    ///                   и длины сообщения (std::uint32_t, little-endian);
+    ///   байты 20..    - N сообщений, каждое - длина L (std::uint32_t, little-endian)
+    ///                   и L байт данных сообщения;
+    ///   байты 20+D..  - только при streamFlagChecksum: CRC-32C (полином Кастаньоли 0x1EDC6F41,
+    ///                   отражённый, начальное значение и итоговое XOR 0xFFFFFFFF;
+    ///                   std::uint32_t, little-endian) байтов 0..20+D-1, то есть включая
+    ///                   заголовок и служебные поля.
+    class BatchEncoder
+    {
+    public:
+        /// Создаёт кодировщик, записывающий кадр в buffer.
+        /// @param  buffer        Выходной буфер размером не менее options.maxBytes.
+        /// @param  targetEndian  Порядок байтов в результате.
+        /// @param  options       Параметры пакета.
+        BatchEncoder(std::span<std::byte> buffer, std::endian targetEndian, const BatchOptions &options = {}) noexcept;
+
+        /// Добавляет в кадр сообщение, состоящее из группы переменных.
+        /// Переменные сериализуются непосредственно в buffer.
+        /// @tparam Args  Типы сериализуемых переменных в группе переменных.
+        /// @param  args  Сериализуемые переменные.
+        /// @return       true, если сообщение добавлено; false, если оно не помещается
+        ///               в текущий кадр (кадр следует отправить вызовом flush и повторить
+        ///               добавление); ошибка SerializationError::bufferTooSmall, если размер
+        ///               сообщения больше maxMessageSize() и оно не поместится даже в пустой кадр.
+        template <typename... Args>
+        Result<bool> add(const Args &...args) noexcept;
+
+        /// @return  Наибольший размер сообщения: options.maxBytes - streamHeaderSize -
+        ///          batchCountsSize - 4 (префикс длины) - 4 (CRC-32C, если options.checksum).
+        std::size_t maxMessageSize() const noexcept;
+
+        /// Проверяет, следует ли отправить кадр: достигнут предел размера или количества
+        /// сообщений, либо с момента добавления первого сообщения прошло options.maxDelay.
+        /// Вызывается из цикла обработки событий владельца.
+        /// @param  now  Текущее время.
+        /// @return      true, если кадр следует отправить.
+        bool readyToFlush(std::chrono::steady_clock::time_point now) const noexcept;
+
+        /// Завершает кадр (записывает количество сообщений и контрольную сумму)
+        /// и начинает новый в том же буфере.
+        /// @return  Завершённый кадр или пустой span, если кадр не содержит сообщений.
+        ///          Действителен до следующего вызова add.
+        std::span<const std::byte> flush() noexcept;
+
+        /// @return  Количество сообщений в текущем кадре.
+        std::size_t messageCount() const noexcept;
+    };
+
+    /// Десериализует кадр пакета сообщений из входного буфера, вызывая handler для каждого
+    /// сообщения в одном цикле. handler вызывается как handler(message, header), где message -
+    /// std::span<const std::byte> с данными сообщения, а header - заголовок кадра, который
+    /// передаётся в deserialize для выбора порядка байтов.
+    /// Формат кадра описан у BatchEncoder.
+    /// Заголовок и контрольная сумма проверяются один раз до первого вызова handler;
+    /// контрольная сумма ожидается и проверяется, только если в заголовке установлен
+    /// флаг streamFlagChecksum. Если D больше остатка буфера, префиксы длины выходят
+    /// за пределы D или количество сообщений в D не равно N, handler не вызывается
+    /// и возвращается ошибка SerializationError::invalidData.
+    /// @tparam Handler  Тип обработчика сообщений.
+    /// @tparam _extent  Extent входного буфера.
+    /// @param  buffer   Входной буфер.
+    /// @param  handler  Обработчик сообщений.
+    /// @return          Result с неиспользуемой частью входного буфера или ошибкой.
+    template <typename Handler, size_t _extent>
+    auto deserializeBatch(std::span<const std::byte, _extent> buffer, Handler &&handler);
+
 }